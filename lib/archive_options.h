@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace hamarc {
+
+struct ArchiveOptions {
+  // Entries whose names match one of these globs are stored verbatim.
+  std::vector<std::string> store_patterns;
+  // Store entries that already look like compressed data.
+  bool store_compressed = false;
+
+  // Check entry data while Append, Delete and Concatenate copy it.
+  bool verify_copy = false;
+  // Like verify_copy, but also fix single-bit errors in the copied data.
+  bool repair_copy = false;
+};
+
+}  // namespace hamarc
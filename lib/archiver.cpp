@@ -1,25 +1,47 @@
 #include "archiver.h"
+#include "archive_options.h"
+#include "crc32c.h"
 #include "hamming_codec.h"
 #include "hamming_options.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint> 
 #include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string> 
 #include <system_error>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace fs=std::filesystem;
 
 namespace hamarc {
 
+enum class EntryMethod : std::uint8_t {
+  kHamming = 0,
+  kStored = 1
+};
+
+// "HA2" archives record the method, Hamming parameters and checksum of
+// every entry. "HAF" archives predate that: all entries are Hamming-coded
+// with parameters that are only known from the command line.
+constexpr char kSignature[] = "HA2";
+constexpr char kLegacySignature[] = "HAF";
+constexpr std::size_t kSignatureSize = 3;
+
 struct FileEntry {
   std::string name;
   std::string source_path;
+  EntryMethod method = EntryMethod::kHamming;
+  // Zero when the parameters are not recorded (legacy entries).
+  std::uint8_t data_bits = 0;
+  std::uint8_t parity_bits = 0;
+  std::uint32_t checksum = 0;
   std::uint64_t original_size = 0;
   std::uint64_t encoded_size = 0;
   std::uint64_t offset = 0;
@@ -27,25 +49,32 @@ struct FileEntry {
 
 namespace {
 
-std::uint64_t CalculateEncodedSize(const HammingCodec& codec, std::uint64_t original_size) {
+constexpr std::size_t kStoredCopyBufferSize = 1 << 16;
+constexpr std::uint64_t kCopyBufferSize = 8192;
+
+std::uint64_t CalculateCodewordCount(const HammingCodec& codec, std::uint64_t original_size) {
   const std::uint64_t original_bits = original_size * 8;
+  const std::uint64_t data_bits = static_cast<std::uint64_t>(codec.DataBits());
+  return (original_bits + data_bits - 1) / data_bits;
+}
 
+std::uint64_t CalculateEncodedSize(const HammingCodec& codec, std::uint64_t original_size) {
   const std::uint64_t data_bits = static_cast<std::uint64_t>(codec.DataBits());
   const std::uint64_t parity_bits = static_cast<std::uint64_t>(codec.ParityBits());
   const std::uint64_t codeword_bits = data_bits + parity_bits;
 
-  const std::uint64_t codeword_count = (original_bits + data_bits - 1) / data_bits;
+  const std::uint64_t codeword_count = CalculateCodewordCount(codec, original_size);
   const std::uint64_t total_code_bits = codeword_count * codeword_bits;
 
   return (total_code_bits + 7) / 8;
 }
 
 std::uint64_t CalculateHeaderSize(const std::vector<FileEntry>& entries) {
-  std::uint64_t header_size = 3 + 4;
+  std::uint64_t header_size = kSignatureSize + 4;
   for (const FileEntry& entry : entries) {
     header_size += 2;
     header_size +=entry.name.size();
-    header_size +=8+8+8;
+    header_size +=1+1+1+4+8+8+8;
   }
   return header_size;
 }
@@ -59,7 +88,7 @@ void AssignOffsets(std::vector<FileEntry>& entries, std::uint64_t header_size) {
 }
 
 bool WriteArchiveHeader(std::ostream& out, const std::vector<FileEntry>& entries) {
-  out.write("HAF", 3);
+  out.write(kSignature, kSignatureSize);
   const std::uint32_t file_count = static_cast<std::uint32_t>(entries.size());
   out.write(reinterpret_cast<const char*>(&file_count), sizeof(file_count));
 
@@ -67,6 +96,11 @@ bool WriteArchiveHeader(std::ostream& out, const std::vector<FileEntry>& entries
     const std::uint16_t name_length = static_cast<std::uint16_t>(entry.name.size());
     out.write(reinterpret_cast<const char*>(&name_length), sizeof(name_length));
     out.write(entry.name.c_str(), name_length);
+    const std::uint8_t method = static_cast<std::uint8_t>(entry.method);
+    out.write(reinterpret_cast<const char*>(&method), sizeof(method));
+    out.write(reinterpret_cast<const char*>(&entry.data_bits), sizeof(entry.data_bits));
+    out.write(reinterpret_cast<const char*>(&entry.parity_bits), sizeof(entry.parity_bits));
+    out.write(reinterpret_cast<const char*>(&entry.checksum), sizeof(entry.checksum));
     out.write(reinterpret_cast<const char*>(&entry.original_size), sizeof(entry.original_size));
     out.write(reinterpret_cast<const char*>(&entry.encoded_size), sizeof(entry.encoded_size));
     out.write(reinterpret_cast<const char*>(&entry.offset), sizeof(entry.offset));
@@ -76,8 +110,13 @@ bool WriteArchiveHeader(std::ostream& out, const std::vector<FileEntry>& entries
 }
 
 bool ReadArchiveHeader(std::ifstream& in,  const std::string& archive_path, std::vector<FileEntry>& entries) {
-  char signature[3];
-  if (!in.read(signature, 3) || std::strncmp(signature, "HAF", 3) != 0) {
+  char signature[kSignatureSize];
+  if (!in.read(signature, kSignatureSize)) {
+    std::cerr << "Invalid or corrupt archive format: " << archive_path << "\n";
+    return false;
+  }
+  const bool is_legacy = std::strncmp(signature, kLegacySignature, kSignatureSize) == 0;
+  if (!is_legacy && std::strncmp(signature, kSignature, kSignatureSize) != 0) {
     std::cerr << "Invalid or corrupt archive format: " << archive_path << "\n";
     return false;
   }
@@ -106,6 +145,16 @@ bool ReadArchiveHeader(std::ifstream& in,  const std::string& archive_path, std:
       return false;
     }
 
+    std::uint8_t method = 0;
+    if (!is_legacy &&
+        (!in.read(reinterpret_cast<char*>(&method), sizeof(method)) ||
+         !in.read(reinterpret_cast<char*>(&entry.data_bits), sizeof(entry.data_bits)) ||
+         !in.read(reinterpret_cast<char*>(&entry.parity_bits), sizeof(entry.parity_bits)) ||
+         !in.read(reinterpret_cast<char*>(&entry.checksum), sizeof(entry.checksum)))) {
+      std::cerr << "Failed to read file metadata.\n";
+      return false;
+    }
+
     if (!in.read(reinterpret_cast<char*>(&entry.original_size), sizeof(entry.original_size)) ||
         !in.read(reinterpret_cast<char*>(&entry.encoded_size), sizeof(entry.encoded_size)) ||
         !in.read(reinterpret_cast<char*>(&entry.offset), sizeof(entry.offset))) {
@@ -113,14 +162,112 @@ bool ReadArchiveHeader(std::ifstream& in,  const std::string& archive_path, std:
       return false;
     }
 
+    if (method != static_cast<std::uint8_t>(EntryMethod::kHamming) &&
+        method != static_cast<std::uint8_t>(EntryMethod::kStored)) {
+      std::cerr << "Unknown storage method for file: " << entry.name << "\n";
+      return false;
+    }
+    entry.method = static_cast<EntryMethod>(method);
+
+    const bool has_parameters = entry.data_bits != 0 || entry.parity_bits != 0;
+    if (has_parameters &&
+        (entry.data_bits > 16 || entry.parity_bits == 0 || entry.parity_bits > 8)) {
+      std::cerr << "Invalid Hamming parameters for file: " << entry.name << "\n";
+      return false;
+    }
+
     entries.push_back(entry);
   }
 
   return true;
 }
 
+// Entries without recorded parameters fall back to the command line ones.
+HammingOptions EntryHammingOptions(const FileEntry& entry, const HammingCodec& fallback) {
+  if (entry.data_bits == 0) {
+    return {fallback.DataBits(), fallback.ParityBits()};
+  }
+  return {entry.data_bits, entry.parity_bits};
+}
+
+bool MatchesGlob(const std::string& pattern, const std::string& name) {
+  std::size_t p = 0;
+  std::size_t n = 0;
+  std::size_t star = std::string::npos;
+  std::size_t star_match = 0;
+
+  while (n < name.size()) {
+    if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+      ++p;
+      ++n;
+    } else if (p < pattern.size() && pattern[p] == '*') {
+      star = p++;
+      star_match = n;
+    } else if (star != std::string::npos) {
+      p = star + 1;
+      n = ++star_match;
+    } else {
+      return false;
+    }
+  }
+
+  while (p < pattern.size() && pattern[p] == '*') {
+    ++p;
+  }
+  return p == pattern.size();
+}
+
+// bzip2 streams start with "BZh", a block size digit and the 48-bit block
+// magic (pi in BCD); the prefix alone would also match plain text.
+bool LooksLikeBzip2(const char* head, std::size_t head_size) {
+  static const char kBlockMagic[] = "\x31\x41\x59\x26\x53\x59";
+  return head_size >= 10 && std::memcmp(head, "BZh", 3) == 0 &&
+         head[3] >= '1' && head[3] <= '9' &&
+         std::memcmp(head + 4, kBlockMagic, 6) == 0;
+}
+
+bool LooksCompressed(const fs::path& path) {
+  struct Magic {
+    const char* bytes;
+    std::size_t size;
+  };
+  static const Magic kKnownMagics[] = {
+      {"\x1F\x8B", 2},                  // gzip
+      {"\x28\xB5\x2F\xFD", 4},          // zstd
+      {"\xFD\x37\x7A\x58\x5A\x00", 6},  // xz
+      {"PK\x03\x04", 4},                // zip
+      {"7z\xBC\xAF\x27\x1C", 6},        // 7z
+      {"\xFF\xD8\xFF", 3},              // jpeg
+      {"\x89PNG", 4},                    // png
+  };
+
+  std::ifstream in(path, std::ios::binary);
+  std::array<char, 10> head{};
+  in.read(head.data(), static_cast<std::streamsize>(head.size()));
+  const std::size_t head_size = static_cast<std::size_t>(in.gcount());
+
+  for (const Magic& magic : kKnownMagics) {
+    if (head_size >= magic.size &&
+        std::memcmp(head.data(), magic.bytes, magic.size) == 0) {
+      return true;
+    }
+  }
+  return LooksLikeBzip2(head.data(), head_size);
+}
+
+bool ShouldStore(const fs::path& path, const std::string& name,
+                 const ArchiveOptions& options) {
+  for (const std::string& pattern : options.store_patterns) {
+    if (MatchesGlob(pattern, name)) {
+      return true;
+    }
+  }
+  return options.store_compressed && LooksCompressed(path);
+}
+
 bool CollectNewEntries(const std::vector<std::string>& input_files,
                        const HammingCodec& codec,
+                       const ArchiveOptions& options,
                        std::vector<FileEntry>& out_entries) {
   out_entries.clear();
   out_entries.reserve(input_files.size());
@@ -132,15 +279,19 @@ bool CollectNewEntries(const std::vector<std::string>& input_files,
       return false;
     }
 
-    const std::uint64_t original_size = fs::file_size(path);
-    const std::uint64_t encoded_size =
-        CalculateEncodedSize(codec, original_size);
-
     FileEntry entry;
     entry.name = path.filename().generic_string();
     entry.source_path = path.generic_string();
-    entry.original_size = original_size;
-    entry.encoded_size = encoded_size;
+    entry.original_size = fs::file_size(path);
+
+    if (ShouldStore(path, entry.name, options)) {
+      entry.method = EntryMethod::kStored;
+      entry.encoded_size = entry.original_size;
+    } else {
+      entry.data_bits = static_cast<std::uint8_t>(codec.DataBits());
+      entry.parity_bits = static_cast<std::uint8_t>(codec.ParityBits());
+      entry.encoded_size = CalculateEncodedSize(codec, entry.original_size);
+    }
     entry.offset = 0;
 
     out_entries.push_back(entry);
@@ -164,8 +315,119 @@ bool EncodeFileToArchive(const FileEntry& entry, HammingCodec& codec, std::ostre
   return true;
 }
 
-bool CopyEntryData(std::ifstream& archive_in, const FileEntry& entry, std::ostream& archive_out) {
-  std::vector<char> buffer(8192);
+bool StoreFileToArchive(FileEntry& entry, std::ostream& archive_out) {
+  std::ifstream in_file(fs::u8path(entry.source_path), std::ios::binary);
+  if (!in_file) {
+    std::cerr << "Failed to open input file: " << entry.source_path << "\n";
+    return false;
+  }
+
+  std::vector<char> buffer(kStoredCopyBufferSize);
+  std::uint32_t checksum = 0;
+  std::uint64_t copied = 0;
+
+  while (in_file.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) ||
+         in_file.gcount() > 0) {
+    const std::streamsize bytes_read = in_file.gcount();
+    checksum = Crc32c(checksum, buffer.data(), static_cast<std::size_t>(bytes_read));
+    archive_out.write(buffer.data(), bytes_read);
+    if (!archive_out.good()) {
+      std::cerr << "Error writing to archive file.\n";
+      return false;
+    }
+    copied += static_cast<std::uint64_t>(bytes_read);
+  }
+
+  if (copied != entry.original_size) {
+    std::cerr << "Input file changed while archiving: " << entry.source_path << "\n";
+    return false;
+  }
+
+  entry.checksum = checksum;
+  return true;
+}
+
+bool WriteEntryData(FileEntry& entry, HammingCodec& codec, std::ostream& archive_out) {
+  if (entry.method == EntryMethod::kStored) {
+    return StoreFileToArchive(entry, archive_out);
+  }
+  return EncodeFileToArchive(entry, codec, archive_out);
+}
+
+// Stored checksums are only known once the data is written, so the header
+// is written a second time on top of the placeholder one.
+bool RewriteArchiveHeader(std::ostream& out, const std::vector<FileEntry>& entries) {
+  out.seekp(0, std::ios::beg);
+  if (!WriteArchiveHeader(out, entries)) {
+    return false;
+  }
+  out.seekp(0, std::ios::end);
+  return out.good();
+}
+
+bool ExtractStoredEntry(std::istream& archive_in, const FileEntry& entry, std::ostream& out) {
+  std::vector<char> buffer(kStoredCopyBufferSize);
+  std::uint32_t checksum = 0;
+
+  std::uint64_t remaining = entry.encoded_size;
+  while (remaining > 0) {
+    const std::streamsize chunk_size =
+        static_cast<std::streamsize>(std::min<std::uint64_t>(remaining, buffer.size()));
+
+    if (!archive_in.read(buffer.data(), chunk_size)) {
+      std::cerr << "Error reading archive data.\n";
+      return false;
+    }
+
+    checksum = Crc32c(checksum, buffer.data(), static_cast<std::size_t>(chunk_size));
+    out.write(buffer.data(), chunk_size);
+    if (!out.good()) {
+      std::cerr << "Error writing output file.\n";
+      return false;
+    }
+
+    remaining -= static_cast<std::uint64_t>(chunk_size);
+  }
+
+  if (checksum != entry.checksum) {
+    std::cerr << "Checksum mismatch: stored data is corrupted.\n";
+    return false;
+  }
+
+  return true;
+}
+
+const char* MethodName(EntryMethod method) {
+  return method == EntryMethod::kStored ? "stored" : "hamming";
+}
+
+// With verification enabled the data is checked in the same pass that
+// copies it: Hamming entries codeword by codeword, stored entries by CRC32C.
+bool CopyEntryData(std::ifstream& archive_in, const FileEntry& entry, const HammingCodec& fallback,
+                   const ArchiveOptions& options, std::ostream& archive_out) {
+  const bool verify = options.verify_copy || options.repair_copy;
+  const bool check_codewords = verify && entry.method == EntryMethod::kHamming;
+  const HammingCodec codec(EntryHammingOptions(entry, fallback));
+
+  if (check_codewords && entry.data_bits == 0) {
+    std::cerr << "Warning: Hamming parameters of file " << entry.name
+              << " are not recorded in the archive; checking it with -D "
+              << codec.DataBits() << " -P " << codec.ParityBits() << ".\n";
+    if (options.repair_copy) {
+      std::cerr << "Warning: if these are not the parameters the file was created with, "
+                   "--repair will damage valid data.\n";
+    }
+  }
+  const std::uint64_t codeword_bits =
+      static_cast<std::uint64_t>(codec.DataBits() + codec.ParityBits());
+
+  // Chunks must hold whole codewords so that every chunk starts on one.
+  std::uint64_t buffer_size = kCopyBufferSize;
+  if (check_codewords) {
+    const std::uint64_t group_size = codec.AlignedGroupCodeBytes();
+    buffer_size = std::max<std::uint64_t>(1, kCopyBufferSize / group_size) * group_size;
+  }
+  std::vector<char> buffer(buffer_size);
 
   archive_in.seekg(entry.offset, std::ios::beg);
   if (!archive_in.good()) {
@@ -173,6 +435,10 @@ bool CopyEntryData(std::ifstream& archive_in, const FileEntry& entry, std::ostre
     return false;
   }
 
+  std::uint64_t codewords_left = CalculateCodewordCount(codec, entry.original_size);
+  std::uint64_t corrected = 0;
+  std::uint32_t checksum = 0;
+
   std::uint64_t remaining = entry.encoded_size;
   while (remaining > 0) {
     const std::streamsize chunk_size =
@@ -184,6 +450,18 @@ bool CopyEntryData(std::ifstream& archive_in, const FileEntry& entry, std::ostre
     }
 
     const std::streamsize bytes_read = archive_in.gcount();
+    if (check_codewords) {
+      const std::uint64_t chunk_codewords = std::min<std::uint64_t>(
+          codewords_left, static_cast<std::uint64_t>(bytes_read) * 8 / codeword_bits);
+      if (!codec.CheckCodewords(buffer.data(), chunk_codewords, options.repair_copy, corrected)) {
+        std::cerr << "Uncorrectable data corruption in file: " << entry.name << "\n";
+        return false;
+      }
+      codewords_left -= chunk_codewords;
+    } else if (verify) {
+      checksum = Crc32c(checksum, buffer.data(), static_cast<std::size_t>(bytes_read));
+    }
+
     archive_out.write(buffer.data(), bytes_read);
     if (!archive_out.good()) {
       std::cerr << "Error writing to archive file.\n";
@@ -193,6 +471,16 @@ bool CopyEntryData(std::ifstream& archive_in, const FileEntry& entry, std::ostre
     remaining -=static_cast<std::uint64_t>(bytes_read);
   }
 
+  if (verify && entry.method == EntryMethod::kStored && checksum != entry.checksum) {
+    std::cerr << "Checksum mismatch in stored file: " << entry.name << "\n";
+    return false;
+  }
+
+  if (corrected > 0) {
+    std::cout << (options.repair_copy ? "Corrected " : "Found correctable errors in ")
+              << corrected << " codeword(s) of file: " << entry.name << std::endl;
+  }
+
   return true;
 }
 
@@ -235,8 +523,9 @@ bool FindEntriesByNames(const std::vector<FileEntry>& all_entries,
 
 } // namespace
 
-Archiver::Archiver(const std::string& archive_path, const HammingOptions& hamming)
-    : archive_path_(archive_path), codec_(hamming) {}
+Archiver::Archiver(const std::string& archive_path, const HammingOptions& hamming,
+                   const ArchiveOptions& options)
+    : archive_path_(archive_path), codec_(hamming), options_(options) {}
 
 bool Archiver::Create(const std::vector<std::string>& input_files) {
   fs::path out_path(archive_path_);
@@ -259,7 +548,7 @@ bool Archiver::Create(const std::vector<std::string>& input_files) {
   }
 
   std::vector<FileEntry> entries;
-  if (!CollectNewEntries(input_files, codec_, entries)) {
+  if (!CollectNewEntries(input_files, codec_, options_, entries)) {
     out.close();
     fs::remove(out_path);
     return false;
@@ -275,14 +564,21 @@ bool Archiver::Create(const std::vector<std::string>& input_files) {
     return false;
   }
 
-  for (const FileEntry& entry : entries) {
-    if (!EncodeFileToArchive(entry, codec_, out)) {
+  for (FileEntry& entry : entries) {
+    if (!WriteEntryData(entry, codec_, out)) {
       out.close();
       fs::remove(out_path);
       return false;
     }
   }
 
+  if (!RewriteArchiveHeader(out, entries)) {
+    std::cerr << "Failed to write archive header.\n";
+    out.close();
+    fs::remove(out_path);
+    return false;
+  }
+
   out.close();
   return true;
 }
@@ -300,7 +596,8 @@ bool Archiver::List() {
   }
 
   for (const FileEntry& entry : entries) {
-    std::cout << entry.name << " (" << entry.original_size << " bytes)" << std::endl;
+    std::cout << entry.name << " (" << entry.original_size << " bytes) ["
+              << MethodName(entry.method) << "]" << std::endl;
   }
 
   return true;
@@ -345,8 +642,24 @@ bool Archiver::Extract(const std::vector<std::string>& requested_files) {
       return false;
     }
 
-    if (!codec_.DecodeStream(in, out_file, entry.original_size, entry.encoded_size)) {
+    // A file that failed its checks must not be left behind looking complete.
+    if (entry.method == EntryMethod::kStored) {
+      if (!ExtractStoredEntry(in, entry, out_file)) {
+        std::cerr << "Failed to extract file: " << entry.name << "\n";
+        out_file.close();
+        std::error_code ec;
+        fs::remove(out_path, ec);
+        return false;
+      }
+      continue;
+    }
+
+    HammingCodec entry_codec(EntryHammingOptions(entry, codec_));
+    if (!entry_codec.DecodeStream(in, out_file, entry.original_size, entry.encoded_size)) {
       std::cerr << "Failed to decode file: " << entry.name << "\n";
+      out_file.close();
+      std::error_code ec;
+      fs::remove(out_path, ec);
       return false;
     }
   }
@@ -367,7 +680,7 @@ bool Archiver::Append(const std::vector<std::string>& input_files) {
   }
 
   std::vector<FileEntry> new_entries;
-  if (!CollectNewEntries(input_files, codec_, new_entries)) {
+  if (!CollectNewEntries(input_files, codec_, options_, new_entries)) {
     return false;
   }
 
@@ -395,21 +708,29 @@ bool Archiver::Append(const std::vector<std::string>& input_files) {
   }
 
   for (const FileEntry& entry : old_entries) {
-    if (!CopyEntryData(in, entry, out)) {
+    if (!CopyEntryData(in, entry, codec_, options_, out)) {
       out.close();
       fs::remove(temp_path, ec);
       return false;
     }
   }
 
-  for (const FileEntry& entry : new_entries) {
-    if (!EncodeFileToArchive(entry, codec_, out)) {
+  for (std::size_t index = 0; index < new_entries.size(); ++index) {
+    FileEntry& entry = all_entries[old_entries.size() + index];
+    if (!WriteEntryData(entry, codec_, out)) {
       out.close();
       fs::remove(temp_path, ec);
       return false;
     }
   }
 
+  if (!RewriteArchiveHeader(out, all_entries)) {
+    std::cerr << "Failed to write archive header.\n";
+    out.close();
+    fs::remove(temp_path, ec);
+    return false;
+  }
+
   out.close();
   in.close();
 
@@ -492,7 +813,7 @@ bool Archiver::Delete(const std::vector<std::string>& files_to_delete) {
   }
 
   for (const FileEntry& entry : keep_entries_old_offsets) {
-    if (!CopyEntryData(in, entry, out)) {
+    if (!CopyEntryData(in, entry, codec_, options_, out)) {
       out.close();
       fs::remove(temp_path, ec);
       return false;
@@ -536,8 +857,7 @@ bool Archiver::Concatenate(const std::vector<std::string>& source_archives) {
 
   struct SourceInfo {
     std::string path;
-    std::uint64_t data_start = 0;
-    std::uint64_t data_length = 0;
+    std::vector<FileEntry> entries;
   };
   std::vector<SourceInfo> sources;
 
@@ -573,11 +893,7 @@ bool Archiver::Concatenate(const std::vector<std::string>& source_archives) {
       combined_entries.push_back(entry);
     }
 
-    const std::uint64_t data_start = static_cast<std::uint64_t>(src_in.tellg());
-    const std::uint64_t file_size = fs::file_size(src_path);
-    const std::uint64_t data_length = (file_size > data_start) ? (file_size - data_start) : 0;
-
-    sources.push_back({src_path, data_start, data_length});
+    sources.push_back({src_path, std::move(src_entries)});
   }
 
   const std::uint64_t header_size = CalculateHeaderSize(combined_entries);
@@ -590,7 +906,6 @@ bool Archiver::Concatenate(const std::vector<std::string>& source_archives) {
     return false;
   }
 
-  std::vector<char> buffer(8192);
   for (const SourceInfo& source : sources) {
     std::ifstream src_in(source.path, std::ios::binary);
     if (!src_in) {
@@ -600,32 +915,13 @@ bool Archiver::Concatenate(const std::vector<std::string>& source_archives) {
       return false;
     }
 
-    src_in.seekg(static_cast<std::streamoff>(source.data_start), std::ios::beg);
-    std::uint64_t remaining = source.data_length;
-
-    while (remaining > 0) {
-      const std::streamsize chunk_size =
-          static_cast<std::streamsize>(std::min<std::uint64_t>(remaining, buffer.size()));
-
-      if (!src_in.read(buffer.data(), chunk_size)) {
-        std::cerr << "Error reading source archive data.\n";
-        src_in.close();
-        out.close();
-        fs::remove(temp_path);
-        return false;
-      }
-
-      const std::streamsize bytes_read = src_in.gcount();
-      out.write(buffer.data(), bytes_read);
-      if (!out.good()) {
-        std::cerr << "Error writing to output archive.\n";
+    for (const FileEntry& entry : source.entries) {
+      if (!CopyEntryData(src_in, entry, codec_, options_, out)) {
         src_in.close();
         out.close();
         fs::remove(temp_path);
         return false;
       }
-
-      remaining -= static_cast<std::uint64_t>(bytes_read);
     }
   }
 
@@ -640,4 +936,104 @@ bool Archiver::Concatenate(const std::vector<std::string>& source_archives) {
   return true;
 }
 
+EntryReader::EntryReader(const std::string& archive_path, const HammingOptions& hamming)
+    : archive_path_(archive_path), fallback_codec_(hamming), codec_(hamming) {}
+
+bool EntryReader::Open(const std::string& entry_name) {
+  in_.close();
+  cache_.clear();
+  in_.open(archive_path_, std::ios::binary);
+  if (!in_) {
+    std::cerr << "Failed to open archive: " << archive_path_ << "\n";
+    return false;
+  }
+
+  std::vector<FileEntry> entries;
+  if (!ReadArchiveHeader(in_, archive_path_, entries)) {
+    return false;
+  }
+
+  std::vector<FileEntry> found;
+  if (!FindEntriesByNames(entries, {entry_name}, found)) {
+    return false;
+  }
+
+  entry_offset_ = found.front().offset;
+  original_size_ = found.front().original_size;
+  is_stored_ = found.front().method == EntryMethod::kStored;
+  codec_ = HammingCodec(EntryHammingOptions(found.front(), fallback_codec_));
+  return true;
+}
+
+bool EntryReader::Read(std::uint64_t offset, std::uint64_t length, char* out) {
+  if (offset > original_size_ || length > original_size_ - offset) {
+    std::cerr << "Read past the end of entry.\n";
+    return false;
+  }
+
+  while (length > 0) {
+    const CachedPage* page = FetchPage(offset / kPageSize);
+    if (page == nullptr) {
+      return false;
+    }
+
+    const std::uint64_t page_offset = offset % kPageSize;
+    const std::uint64_t chunk =
+        std::min<std::uint64_t>(length, page->data.size() - page_offset);
+    std::memcpy(out, page->data.data() + page_offset, chunk);
+
+    out += chunk;
+    offset += chunk;
+    length -= chunk;
+  }
+
+  return true;
+}
+
+const EntryReader::CachedPage* EntryReader::FetchPage(std::uint64_t page_index) {
+  ++use_counter_;
+  for (CachedPage& page : cache_) {
+    if (page.index == page_index) {
+      page.last_use = use_counter_;
+      return &page;
+    }
+  }
+
+  in_.clear();
+  std::vector<char> data;
+  if (is_stored_) {
+    const std::uint64_t page_start = page_index * kPageSize;
+    data.resize(std::min<std::uint64_t>(kPageSize, original_size_ - page_start));
+    in_.seekg(static_cast<std::streamoff>(entry_offset_ + page_start), std::ios::beg);
+    if (!in_.read(data.data(), static_cast<std::streamsize>(data.size()))) {
+      std::cerr << "Failed to read page " << page_index << " of entry.\n";
+      return nullptr;
+    }
+  } else {
+    in_.seekg(static_cast<std::streamoff>(entry_offset_), std::ios::beg);
+    std::ostringstream decoded;
+    if (!codec_.DecodeRange(in_, decoded, original_size_, page_index * kPageSize, kPageSize)) {
+      std::cerr << "Failed to decode page " << page_index << " of entry.\n";
+      return nullptr;
+    }
+    const std::string bytes = decoded.str();
+    data.assign(bytes.begin(), bytes.end());
+  }
+
+  CachedPage* slot = nullptr;
+  if (cache_.size() < kCachedPages) {
+    slot = &cache_.emplace_back();
+  } else {
+    slot = &*std::min_element(cache_.begin(), cache_.end(),
+                              [](const CachedPage& a, const CachedPage& b) {
+                                return a.last_use < b.last_use;
+                              });
+  }
+
+  slot->index = page_index;
+  slot->last_use = use_counter_;
+  slot->data = std::move(data);
+  return slot;
+}
+
 }  // namespace hamarc
\ No newline at end of file
@@ -1,8 +1,11 @@
 #ifndef HAMARC_ARCHIVER_H_
 #define HAMARC_ARCHIVER_H_
 
+#include <cstdint>
+#include <fstream>
 #include <string>
 #include <vector>
+#include "archive_options.h"
 #include "hamming_codec.h"
 #include "hamming_options.h"
 
@@ -10,7 +13,8 @@ namespace hamarc {
 
 class Archiver {
  public:
-  Archiver(const std::string& archive_path, const HammingOptions& hamming);
+  Archiver(const std::string& archive_path, const HammingOptions& hamming,
+           const ArchiveOptions& options = ArchiveOptions{});
 
   Archiver(const Archiver&) = delete;
   Archiver& operator=(const Archiver&) = delete;
@@ -25,6 +29,44 @@ class Archiver {
  private:
   std::string archive_path_;
   HammingCodec codec_;
+  ArchiveOptions options_;
+};
+
+// Random read access to the decoded contents of a single archive entry.
+// Only the pages that are actually touched get decoded; recently used pages
+// are kept in a small cache.
+class EntryReader {
+ public:
+  EntryReader(const std::string& archive_path, const HammingOptions& hamming);
+
+  EntryReader(const EntryReader&) = delete;
+  EntryReader& operator=(const EntryReader&) = delete;
+
+  bool Open(const std::string& entry_name);
+  std::uint64_t Size() const { return original_size_; }
+  bool Read(std::uint64_t offset, std::uint64_t length, char* out);
+
+ private:
+  static constexpr std::uint64_t kPageSize = 4096;
+  static constexpr std::size_t kCachedPages = 16;
+
+  struct CachedPage {
+    std::uint64_t index = 0;
+    std::uint64_t last_use = 0;
+    std::vector<char> data;
+  };
+
+  const CachedPage* FetchPage(std::uint64_t page_index);
+
+  std::string archive_path_;
+  HammingCodec fallback_codec_;
+  HammingCodec codec_;
+  std::ifstream in_;
+  std::uint64_t entry_offset_ = 0;
+  std::uint64_t original_size_ = 0;
+  bool is_stored_ = false;
+  std::uint64_t use_counter_ = 0;
+  std::vector<CachedPage> cache_;
 };
 
 }  // namespace hamarc
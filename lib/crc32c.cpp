@@ -0,0 +1,37 @@
+#include "crc32c.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace hamarc {
+namespace {
+
+constexpr std::uint32_t kCastagnoliPolynomial = 0x82F63B78u;
+
+constexpr std::array<std::uint32_t, 256> BuildCrcTable() {
+  std::array<std::uint32_t, 256> table{};
+  for (std::uint32_t index = 0; index < 256; ++index) {
+    std::uint32_t value = index;
+    for (int bit = 0; bit < 8; ++bit) {
+      value = (value & 1u) ? (value >> 1) ^ kCastagnoliPolynomial : value >> 1;
+    }
+    table[index] = value;
+  }
+  return table;
+}
+
+constexpr std::array<std::uint32_t, 256> kCrcTable = BuildCrcTable();
+
+}  // namespace
+
+std::uint32_t Crc32c(std::uint32_t crc, const void* data, std::size_t size) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  crc = ~crc;
+  for (std::size_t index = 0; index < size; ++index) {
+    crc = kCrcTable[(crc ^ bytes[index]) & 0xFFu] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+}  // namespace hamarc
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace hamarc {
+
+// CRC-32C (Castagnoli). Start with crc = 0 and feed the previous result back
+// in to checksum data that arrives in several chunks.
+std::uint32_t Crc32c(std::uint32_t crc, const void* data, std::size_t size);
+
+}  // namespace hamarc
@@ -1,4 +1,5 @@
 #include "hamarc_core.h"
+#include "archive_options.h"
 #include "archiver.h"
 #include "hamming_options.h"
 #include "parse_args.h"
@@ -7,6 +8,18 @@
 #include <iostream>
 
 namespace hamarc {
+namespace {
+
+ArchiveOptions MakeArchiveOptions(const ParsedOptions& options) {
+  ArchiveOptions archive_options;
+  archive_options.store_patterns = options.store_patterns;
+  archive_options.store_compressed = options.store_compressed;
+  archive_options.verify_copy = options.verify;
+  archive_options.repair_copy = options.repair;
+  return archive_options;
+}
+
+}  // namespace
 
 int RunFromOptions(const ParsedOptions& options) {
   switch (options.command) {
@@ -31,7 +44,7 @@ int RunFromOptions(const ParsedOptions& options) {
 
 int RunCreate(const ParsedOptions& options) {
   HammingOptions hopt{options.hamming.data_bits, options.hamming.parity_bits};
-  Archiver archiver(options.archive_path, hopt);
+  Archiver archiver(options.archive_path, hopt, MakeArchiveOptions(options));
   bool success = archiver.Create(options.files);
   return success ? 0 : 1;
 }
@@ -52,14 +65,14 @@ int RunExtract(const ParsedOptions& options) {
 
 int RunAppend(const ParsedOptions& options) {
   HammingOptions hopt{options.hamming.data_bits, options.hamming.parity_bits};
-  Archiver archiver(options.archive_path, hopt);
+  Archiver archiver(options.archive_path, hopt, MakeArchiveOptions(options));
   bool success = archiver.Append(options.files);
   return success ? 0 : 1;
 }
 
 int RunDelete(const ParsedOptions& options) {
   HammingOptions hopt{options.hamming.data_bits, options.hamming.parity_bits};
-  Archiver archiver(options.archive_path, hopt);
+  Archiver archiver(options.archive_path, hopt, MakeArchiveOptions(options));
   bool success = archiver.Delete(options.files);
   return success ? 0 : 1;
 }
@@ -70,7 +83,7 @@ int RunConcatenate(const ParsedOptions& options) {
     return 1;
   }
   HammingOptions hopt{options.hamming.data_bits, options.hamming.parity_bits};
-  Archiver archiver(options.archive_path, hopt);
+  Archiver archiver(options.archive_path, hopt, MakeArchiveOptions(options));
   bool success = archiver.Concatenate(options.files);
   return success ? 0 : 1;
 }
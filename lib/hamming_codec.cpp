@@ -1,37 +1,41 @@
 #include "hamming_codec.h"
 #include "hamming_options.h"
 
+#include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <iostream>
+#include <numeric>
 #include <utility>
 
 namespace hamarc {
 namespace {
 
-unsigned int CalculateSyndrome(std::uint32_t codeword, int total_bits) {
+// Parity bit p covers every position that has bit p set, so the syndrome is
+// simply the XOR of the (1-based) positions of all set bits.
+unsigned int CalculateSyndrome(std::uint32_t codeword) {
   unsigned int syndrome = 0;
 
-  for (int parity_position = 1; parity_position <= total_bits;
-       parity_position <<= 1) {
-    if (parity_position > total_bits) {
-      break;
-    }
+  while (codeword != 0) {
+    syndrome ^= static_cast<unsigned int>(std::countr_zero(codeword)) + 1;
+    codeword &= codeword - 1;
+  }
 
-    int parity_value = 0;
-    for (int bit_index = 1; bit_index <= total_bits; ++bit_index) {
-      if (bit_index & parity_position) {
-        if (codeword & (1u << (bit_index - 1))) {
-          parity_value ^= 1;
-        }
-      }
-    }
+  return syndrome;
+}
 
-    if (parity_value) {
-      syndrome |= static_cast<unsigned int>(parity_position);
-    }
+std::uint32_t LoadCodeword(const unsigned char* bytes, std::uint64_t bit_offset,
+                           int total_bits) {
+  const unsigned char* first = bytes + bit_offset / 8;
+  const int shift = static_cast<int>(bit_offset % 8);
+  const int byte_count = (shift + total_bits + 7) / 8;
+
+  std::uint64_t window = 0;
+  for (int byte_index = 0; byte_index < byte_count; ++byte_index) {
+    window |= static_cast<std::uint64_t>(first[byte_index]) << (8 * byte_index);
   }
 
-  return syndrome;
+  return static_cast<std::uint32_t>((window >> shift) & ((1ull << total_bits) - 1));
 }
 
 std::uint32_t ExtractDataBits(std::uint32_t codeword, int total_bits) {
@@ -54,6 +58,12 @@ std::uint32_t ExtractDataBits(std::uint32_t codeword, int total_bits) {
   return data_value;
 }
 
+std::uint64_t CodewordsPerAlignedGroup(int data_bits, int total_bits) {
+  const int data_period = 8 / std::gcd(8, data_bits);
+  const int code_period = 8 / std::gcd(8, total_bits);
+  return static_cast<std::uint64_t>(std::lcm(data_period, code_period));
+}
+
 }  // namespace
 
 HammingCodec::HammingCodec(const HammingOptions& opts)
@@ -107,46 +117,48 @@ bool HammingCodec::EncodeStream(std::istream& in, std::ostream& out) {
 
 bool HammingCodec::DecodeStream(std::istream& in, std::ostream& out,
                                 std::uint64_t original_size, std::uint64_t) {
+  return DecodeRange(in, out, original_size, 0, original_size);
+}
+
+bool HammingCodec::DecodeRange(std::istream& in, std::ostream& out,
+                               std::uint64_t original_size,
+                               std::uint64_t byte_offset, std::uint64_t length) {
   if (!in.good() || !out.good()) {
     return false;
   }
 
-  const std::uint64_t original_bits = original_size * 8;
-  if (original_bits == 0) {
+  if (byte_offset >= original_size || length == 0) {
     return true;
   }
+  length = std::min(length, original_size - byte_offset);
 
-  const std::uint64_t data_bits_u64 = static_cast<std::uint64_t>(data_bits_);
-  const std::uint64_t codeword_bits = static_cast<std::uint64_t>(total_bits_);
-  const std::uint64_t codeword_count =
-      (original_bits + data_bits_u64 - 1) / data_bits_u64;
-  const std::uint64_t total_code_bits = codeword_count * codeword_bits;
+  const std::uint64_t group_index = byte_offset / AlignedGroupDataBytes();
+  in.seekg(static_cast<std::streamoff>(group_index * AlignedGroupCodeBytes()),
+           std::ios::cur);
+  if (!in.good()) {
+    return false;
+  }
+
+  const std::uint64_t first_wanted_bit = byte_offset * 8;
+  const std::uint64_t end_bit = (byte_offset + length) * 8;
+  std::uint64_t data_bit = group_index * AlignedGroupDataBytes() * 8;
 
   unsigned char input_byte = 0;
   int input_bits_available = 0;
 
-  std::uint64_t bits_read = 0;
-  std::uint32_t codeword_value = 0;
-  int codeword_bits_collected = 0;
-
   unsigned char output_byte = 0;
   int output_bits_filled = 0;
-  std::uint64_t bits_written = 0;
-
-  while (bits_read < total_code_bits) {
-    int encoded_bit = 0;
-    if (!ReadNextEncodedBit(in, input_byte, input_bits_available, encoded_bit)) {
-      return false;
-    }
 
-    if (encoded_bit) {
-      codeword_value |= (1u << codeword_bits_collected);
-    }
-    ++codeword_bits_collected;
-    ++bits_read;
-
-    if (codeword_bits_collected != total_bits_) {
-      continue;
+  while (data_bit < end_bit) {
+    std::uint32_t codeword_value = 0;
+    for (int bit_index = 0; bit_index < total_bits_; ++bit_index) {
+      int encoded_bit = 0;
+      if (!ReadNextEncodedBit(in, input_byte, input_bits_available, encoded_bit)) {
+        return false;
+      }
+      if (encoded_bit) {
+        codeword_value |= (1u << bit_index);
+      }
     }
 
     auto [decoded_data, has_error] = DecodeBlock(codeword_value);
@@ -156,28 +168,59 @@ bool HammingCodec::DecodeStream(std::istream& in, std::ostream& out,
       return false;
     }
 
-    int bits_to_output = data_bits_;
-    if (bits_written + bits_to_output > original_bits) {
-      bits_to_output =
-          static_cast<int>(original_bits - bits_written);
-    }
-
-    for (int bit_index = 0; bit_index < bits_to_output; ++bit_index) {
+    for (int bit_index = 0; bit_index < data_bits_ && data_bit < end_bit;
+         ++bit_index, ++data_bit) {
+      if (data_bit < first_wanted_bit) {
+        continue;
+      }
       int data_bit_value = (decoded_data >> bit_index) & 1;
       if (!WriteDecodedBitToStream(data_bit_value, output_byte,
                                    output_bits_filled, out)) {
         return false;
       }
     }
-
-    bits_written += static_cast<std::uint64_t>(bits_to_output);
-    codeword_value = 0;
-    codeword_bits_collected = 0;
   }
 
   return FlushOutputByte(output_byte, output_bits_filled, out);
 }
 
+std::uint64_t HammingCodec::AlignedGroupDataBytes() const {
+  return CodewordsPerAlignedGroup(data_bits_, total_bits_) *
+         static_cast<std::uint64_t>(data_bits_) / 8;
+}
+
+std::uint64_t HammingCodec::AlignedGroupCodeBytes() const {
+  return CodewordsPerAlignedGroup(data_bits_, total_bits_) *
+         static_cast<std::uint64_t>(total_bits_) / 8;
+}
+
+bool HammingCodec::CheckCodewords(char* data, std::uint64_t codeword_count, bool repair,
+                                  std::uint64_t& corrected) const {
+  unsigned char* bytes = reinterpret_cast<unsigned char*>(data);
+  std::uint64_t bit_offset = 0;
+
+  for (std::uint64_t index = 0; index < codeword_count; ++index) {
+    const std::uint32_t codeword = LoadCodeword(bytes, bit_offset, total_bits_);
+    const unsigned int syndrome = CalculateSyndrome(codeword);
+
+    if (syndrome != 0U) {
+      if (syndrome > static_cast<unsigned int>(total_bits_)) {
+        return false;
+      }
+
+      ++corrected;
+      if (repair) {
+        const std::uint64_t bad_bit = bit_offset + syndrome - 1;
+        bytes[bad_bit / 8] ^= static_cast<unsigned char>(1u << (bad_bit % 8));
+      }
+    }
+
+    bit_offset += static_cast<std::uint64_t>(total_bits_);
+  }
+
+  return true;
+}
+
 bool HammingCodec::EncodeAndWriteBlock(std::uint32_t data_block, unsigned char& out_byte,
                                        int& out_bit_count, std::ostream& out) {
   const std::uint32_t codeword = EncodeBlock(data_block);
@@ -289,7 +332,7 @@ std::uint32_t HammingCodec::EncodeBlock(std::uint32_t data_value) {
 
 std::pair<std::uint32_t, bool> HammingCodec::DecodeBlock(
     std::uint32_t codeword) {
-  unsigned int syndrome = CalculateSyndrome(codeword, total_bits_);
+  unsigned int syndrome = CalculateSyndrome(codeword);
   bool has_error = false;
 
   if (syndrome != 0U) {
@@ -301,7 +344,7 @@ std::pair<std::uint32_t, bool> HammingCodec::DecodeBlock(
   }
 
   if (!has_error) {
-    unsigned int verify_syndrome = CalculateSyndrome(codeword, total_bits_);
+    unsigned int verify_syndrome = CalculateSyndrome(codeword);
     if (verify_syndrome != 0U) {
       has_error = true;
     }
@@ -17,6 +17,24 @@ class HammingCodec {
   bool DecodeStream(std::istream& in, std::ostream& out,
                     std::uint64_t original_size, std::uint64_t encoded_size);
 
+  // Decodes `length` bytes starting at `byte_offset` of an entry whose encoded
+  // data begins at the current position of `in`. Seeks straight to the first
+  // codeword-aligned group that covers `byte_offset` instead of decoding from
+  // the beginning of the entry.
+  bool DecodeRange(std::istream& in, std::ostream& out, std::uint64_t original_size,
+                   std::uint64_t byte_offset, std::uint64_t length);
+
+  // Smallest run of codewords that starts and ends on a byte boundary both in
+  // the decoded data and in the encoded stream.
+  std::uint64_t AlignedGroupDataBytes() const;
+  std::uint64_t AlignedGroupCodeBytes() const;
+
+  // Checks `codeword_count` codewords packed from the first bit of `data`.
+  // Single-bit errors are counted in `corrected` and, when `repair` is set,
+  // fixed in place. Returns false on the first uncorrectable codeword.
+  bool CheckCodewords(char* data, std::uint64_t codeword_count, bool repair,
+                      std::uint64_t& corrected) const;
+
   int DataBits() const { return data_bits_; }
   int ParityBits() const { return parity_bits_; }
 
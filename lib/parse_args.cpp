@@ -1,6 +1,7 @@
 #include "parse_args.h"
 
 #include <cstdio>
+#include <cstring>
 #include <utility>
 #include <string>
 #include <vector>
@@ -12,6 +13,10 @@ namespace {
 
 using nargparse::ArgumentParser;
 
+constexpr const char kStoreDescription[] =
+    "Store files matching glob verbatim (with CRC32C), may be repeated";
+constexpr const char kStoreIfCompressed[] = "compressed";
+
 struct RawCliOptions {
   bool is_create_mode = false;
   bool is_list_mode = false;
@@ -22,25 +27,31 @@ struct RawCliOptions {
 
   bool is_help_requested = false;
 
+  bool is_verify_requested = false;
+  bool is_repair_requested = false;
+
   static constexpr int kMaxPathLength = 4096;
   char archive_path[kMaxPathLength];
 
   int hamming_data_bits = 8;
   int hamming_parity_bits = 4;
 
+  char store_if[kMaxPathLength];
+
   RawCliOptions() {
     archive_path[0] = '\0';
+    store_if[0] = '\0';
   }
 };
 
-void CollectFiles(ArgumentParser parser, std::vector<std::string>& out) {
-  const int count = nargparse::GetRepeatedCount(parser, "files");
+void CollectStrings(ArgumentParser parser, const char* name, std::vector<std::string>& out) {
+  const int count = nargparse::GetRepeatedCount(parser, name);
   out.clear();
   out.reserve(count);
 
   for (int i = 0; i < count; ++i) {
     const char* value = nullptr;
-    if (nargparse::GetRepeated(parser, "files", i, &value) &&
+    if (nargparse::GetRepeated(parser, name, i, &value) &&
         value != nullptr) {
       out.emplace_back(value);
     }
@@ -95,6 +106,26 @@ void AddHammingArguments(ArgumentParser parser, RawCliOptions& raw_options) {
                          &ValidateHammingParityBits,  "must be > 0 and <= 8");
 }
 
+bool ValidateStoreIfRule(const char* const& value) {
+  return std::strcmp(value, kStoreIfCompressed) == 0;
+}
+
+void AddStoreArguments(ArgumentParser parser, RawCliOptions& raw_options) {
+  nargparse::AddArgument(parser, "-s", "--store", static_cast<char (*)[]>(nullptr),
+                         kStoreDescription, nargparse::kNargsZeroOrMore);
+
+  nargparse::AddArgument(parser, "-S", "--store-if", &raw_options.store_if,
+                         "Store files matching rule verbatim", nargparse::kNargsOptional,
+                         &ValidateStoreIfRule, "supported rule: compressed");
+}
+
+void AddVerifyFlags(ArgumentParser parser, RawCliOptions& raw_options) {
+  nargparse::AddFlag(parser, "-V", "--verify", &raw_options.is_verify_requested,
+                     "Verify copied entries on append, delete and concatenate");
+  nargparse::AddFlag(parser, "-R", "--repair", &raw_options.is_repair_requested,
+                     "Like --verify, also fix single-bit errors in copied entries");
+}
+
 void AddFilesArgument(ArgumentParser parser) {
   nargparse::AddArgument(parser, static_cast<char (*)[]>(nullptr),
                          "files", nargparse::kNargsZeroOrMore);
@@ -108,6 +139,8 @@ ArgumentParser CreateParserWithAllOptions(RawCliOptions& raw_options) {
   AddHelpFlag(parser, raw_options);
   AddArchiveArgument(parser, raw_options);
   AddHammingArguments(parser, raw_options);
+  AddStoreArguments(parser, raw_options);
+  AddVerifyFlags(parser, raw_options);
   AddFilesArgument(parser);
 
   return parser;
@@ -200,9 +233,13 @@ void FillParsedOptionsFromRaw(const RawCliOptions& raw_options, ArgumentParser p
                               ParsedOptions& parsed) {
   parsed.command = DetectCommand(raw_options);
   parsed.archive_path = raw_options.archive_path;
-  CollectFiles(parser, parsed.files);
+  CollectStrings(parser, "files", parsed.files);
   parsed.hamming.data_bits = raw_options.hamming_data_bits;
   parsed.hamming.parity_bits = raw_options.hamming_parity_bits;
+  CollectStrings(parser, kStoreDescription, parsed.store_patterns);
+  parsed.store_compressed = std::strcmp(raw_options.store_if, kStoreIfCompressed) == 0;
+  parsed.verify = raw_options.is_verify_requested;
+  parsed.repair = raw_options.is_repair_requested;
 }
 
 bool ValidateOptionsByMode(const ParsedOptions& parsed, ArgumentParser parser,
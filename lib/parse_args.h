@@ -28,6 +28,12 @@ struct ParsedOptions {
 
   HammingParameters hamming;
 
+  std::vector<std::string> store_patterns;
+  bool store_compressed = false;
+
+  bool verify = false;
+  bool repair = false;
+
   bool show_help = false;
 };
 
@@ -182,7 +182,7 @@ TEST(HamArcCLI, CreateAndExtractAndCompare) {
 		ASSERT_TRUE(archive_file.is_open());
 
 		std::vector<std::pair<std::uintmax_t, int>> flipped_bits = {
-			{100, 0},
+			{archive_size / 4, 0},
 			{archive_size / 2, 0},
 			{archive_size - 1, 0}
 		};
@@ -444,4 +444,352 @@ TEST(HamArcCLI, ExtractMissingFileFails) {
 
   EXPECT_NE(RunHamArc({"--extract", FileFlag(archive), "absent.bin"}, out_dir), 0);
   EXPECT_FALSE(fs::exists(out_dir / "present.bin"));
-}
\ No newline at end of file
+}
+
+TEST(HamArcCLI, StoredEntriesRoundTripAndDetectCorruption) {
+  TempDir td("hamarc_stored");
+  const fs::path in_dir = td.root / "in";
+  const fs::path out_dir = td.root / "out";
+  const fs::path bad_dir = td.root / "bad";
+  ASSERT_TRUE(fs::create_directories(in_dir));
+  ASSERT_TRUE(fs::create_directories(out_dir));
+  ASSERT_TRUE(fs::create_directories(bad_dir));
+
+  const fs::path encoded = in_dir / "plain.bin";
+  const fs::path stored = in_dir / "packed.zip";
+  WriteDeterministicFile(encoded, 8 * 1024, 31);
+  WriteDeterministicFile(stored, 20 * 1024, 32);
+
+  const fs::path archive = td.root / "a.haf";
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(archive), "\"--store=*.zip\"",
+                       QuotePath(encoded), QuotePath(stored)}), 0);
+
+  const fs::path list_out = td.root / "list.txt";
+  const fs::path list_err = td.root / "list.err";
+  ASSERT_EQ(RunHamArcCapture({"--list", FileFlag(archive)}, list_out, list_err), 0);
+  const std::string text = ReadAllText(list_out);
+  EXPECT_NE(text.find("plain.bin (8192 bytes) [hamming]"), std::string::npos);
+  EXPECT_NE(text.find("packed.zip (20480 bytes) [stored]"), std::string::npos);
+
+  ASSERT_EQ(RunHamArc({"--extract", FileFlag(archive)}, out_dir), 0);
+  EXPECT_TRUE(FilesEqual(encoded, out_dir / "plain.bin"));
+  EXPECT_TRUE(FilesEqual(stored, out_dir / "packed.zip"));
+
+  FlipBitInFile(archive, fs::file_size(archive) - 1, /*bit_pos=*/3);
+  EXPECT_NE(RunHamArc({"--extract", FileFlag(archive), "packed.zip"}, bad_dir), 0);
+  EXPECT_FALSE(fs::exists(bad_dir / "packed.zip"));
+}
+
+// Encoded size of an entry with the default -D 8 -P 4: 12 bits per byte.
+static std::uint64_t EncodedSize8x4(std::uint64_t original_size) {
+  return original_size * 12 / 8;
+}
+
+// Flips bits 5 and 10 of the codeword at `codeword_byte`; their positions XOR
+// to syndrome 15, which is past the 12-bit codeword and thus uncorrectable.
+static void BreakFirstCodeword(const fs::path& archive, std::uint64_t codeword_byte) {
+  FlipBitInFile(archive, codeword_byte, /*bit_pos=*/4);
+  FlipBitInFile(archive, codeword_byte + 1, /*bit_pos=*/1);
+}
+
+TEST(HamArcCLI, VerifyWhileCopyingRepairsOrRejectsDamagedEntries) {
+  TempDir td("hamarc_verify_copy");
+  const fs::path in_dir = td.root / "in";
+  ASSERT_TRUE(fs::create_directories(in_dir));
+
+  const fs::path f1 = in_dir / "data.bin";
+  const fs::path f2 = in_dir / "more.bin";
+  WriteDeterministicFile(f1, 16 * 1024, 41);
+  WriteDeterministicFile(f2, 4 * 1024, 42);
+
+  const fs::path clean = td.root / "clean.haf";
+  const fs::path damaged = td.root / "damaged.haf";
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(clean), QuotePath(f1)}), 0);
+  fs::copy_file(clean, damaged);
+
+  FlipBitInFile(damaged, /*byte_pos=*/5000, /*bit_pos=*/2);
+  ASSERT_EQ(RunHamArc({"--append", FileFlag(clean), QuotePath(f2)}), 0);
+  ASSERT_EQ(RunHamArc({"--append", FileFlag(damaged), "--repair", QuotePath(f2)}), 0);
+  EXPECT_TRUE(FilesEqual(clean, damaged));
+
+  const fs::path broken = td.root / "broken.haf";
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(broken), QuotePath(f1)}), 0);
+  BreakFirstCodeword(broken, fs::file_size(broken) - EncodedSize8x4(16 * 1024));
+  const fs::path broken_copy = td.root / "broken_copy.haf";
+  fs::copy_file(broken, broken_copy);
+
+  EXPECT_NE(RunHamArc({"--append", FileFlag(broken), "--verify", QuotePath(f2)}), 0);
+  EXPECT_TRUE(FilesEqual(broken, broken_copy));
+}
+
+TEST(HamArcCLI, VerifyWhileCopyingCoversDeleteAndConcatenate) {
+  TempDir td("hamarc_verify_rewrites");
+  const fs::path in_dir = td.root / "in";
+  ASSERT_TRUE(fs::create_directories(in_dir));
+
+  const fs::path f1 = in_dir / "first.bin";
+  const fs::path f2 = in_dir / "second.bin";
+  WriteDeterministicFile(f1, 6 * 1024, 101);
+  WriteDeterministicFile(f2, 2 * 1024, 102);
+
+  const fs::path a1 = td.root / "a1.haf";
+  const fs::path a2 = td.root / "a2.haf";
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(a1), QuotePath(f1)}), 0);
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(a2), QuotePath(f2)}), 0);
+
+  // Concatenate --repair fixes a single-bit error in a source archive.
+  const fs::path damaged = td.root / "damaged.haf";
+  fs::copy_file(a1, damaged);
+  FlipBitInFile(damaged, fs::file_size(damaged) - 100, /*bit_pos=*/6);
+
+  const fs::path merged_clean = td.root / "merged_clean.haf";
+  const fs::path merged_repaired = td.root / "merged_repaired.haf";
+  ASSERT_EQ(RunHamArc({"--concatenate", FileFlag(merged_clean), QuotePath(a1), QuotePath(a2)}), 0);
+  ASSERT_EQ(RunHamArc({"--concatenate", FileFlag(merged_repaired), "--repair",
+                       QuotePath(damaged), QuotePath(a2)}), 0);
+  EXPECT_TRUE(FilesEqual(merged_clean, merged_repaired));
+
+  // Uncorrectable damage aborts both Delete and Concatenate.
+  const fs::path broken = td.root / "broken.haf";
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(broken), QuotePath(f1), QuotePath(f2)}), 0);
+  BreakFirstCodeword(broken, fs::file_size(broken) - EncodedSize8x4(6 * 1024) -
+                                 EncodedSize8x4(2 * 1024));
+  const fs::path broken_copy = td.root / "broken_copy.haf";
+  fs::copy_file(broken, broken_copy);
+
+  EXPECT_NE(RunHamArc({"--delete", FileFlag(broken), "--verify", "second.bin"}), 0);
+  EXPECT_TRUE(FilesEqual(broken, broken_copy));
+
+  const fs::path merged_broken = td.root / "merged_broken.haf";
+  EXPECT_NE(RunHamArc({"--concatenate", FileFlag(merged_broken), "--verify",
+                       QuotePath(broken), QuotePath(a2)}), 0);
+  EXPECT_FALSE(fs::exists(merged_broken));
+}
+
+TEST(HamArcCLI, VerifyWhileCopyingChecksStoredEntries) {
+  TempDir td("hamarc_verify_stored");
+  const fs::path in_dir = td.root / "in";
+  ASSERT_TRUE(fs::create_directories(in_dir));
+
+  const fs::path stored = in_dir / "packed.zip";
+  const fs::path added = in_dir / "added.bin";
+  WriteDeterministicFile(stored, 4 * 1024, 111);
+  WriteDeterministicFile(added, 1024, 112);
+
+  const fs::path archive = td.root / "a.haf";
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(archive), "\"--store=*.zip\"", QuotePath(stored)}), 0);
+  FlipBitInFile(archive, fs::file_size(archive) - 1, /*bit_pos=*/7);
+
+  const fs::path copy = td.root / "copy.haf";
+  fs::copy_file(archive, copy);
+
+  EXPECT_NE(RunHamArc({"--append", FileFlag(archive), "--verify", QuotePath(added)}), 0);
+  EXPECT_TRUE(FilesEqual(archive, copy));
+
+  const fs::path merged = td.root / "merged.haf";
+  EXPECT_NE(RunHamArc({"--concatenate", FileFlag(merged), "--repair",
+                       QuotePath(archive), QuotePath(copy)}), 0);
+  EXPECT_FALSE(fs::exists(merged));
+
+  // Without verification the damaged bytes are copied as they are.
+  EXPECT_EQ(RunHamArc({"--append", FileFlag(archive), QuotePath(added)}), 0);
+}
+
+TEST(HamArcCLI, ReadsArchivesInLegacyLayout) {
+  TempDir td("hamarc_legacy");
+  const fs::path in_dir = td.root / "in";
+  const fs::path out_dir = td.root / "out";
+  ASSERT_TRUE(fs::create_directories(in_dir));
+  ASSERT_TRUE(fs::create_directories(out_dir));
+
+  const fs::path f1 = in_dir / "old.bin";
+  const fs::path f2 = in_dir / "new.bin";
+  WriteDeterministicFile(f1, 1024, 51);
+  WriteDeterministicFile(f2, 2048, 52);
+
+  // With -D 8 -P 4 every byte becomes 12 bits, so the encoded data of a
+  // single entry is the last 1536 bytes of the archive.
+  const fs::path current = td.root / "current.haf";
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(current), QuotePath(f1)}), 0);
+  const std::uint64_t original_size = 1024;
+  const std::uint64_t encoded_size = 1536;
+  std::vector<char> data(encoded_size);
+  {
+    std::ifstream in(current, std::ios::binary);
+    in.seekg(-static_cast<std::streamoff>(encoded_size), std::ios::end);
+    ASSERT_TRUE(in.read(data.data(), static_cast<std::streamsize>(data.size())));
+  }
+
+  // Old layout: "HAF", file count, then name length, name, original size,
+  // encoded size and offset for each entry.
+  const fs::path archive = td.root / "legacy.haf";
+  {
+    const std::string name = "old.bin";
+    const std::uint32_t file_count = 1;
+    const std::uint16_t name_length = static_cast<std::uint16_t>(name.size());
+    const std::uint64_t offset = 3 + 4 + 2 + name.size() + 8 + 8 + 8;
+
+    std::ofstream out(archive, std::ios::binary | std::ios::trunc);
+    out.write("HAF", 3);
+    out.write(reinterpret_cast<const char*>(&file_count), sizeof(file_count));
+    out.write(reinterpret_cast<const char*>(&name_length), sizeof(name_length));
+    out.write(name.data(), static_cast<std::streamsize>(name.size()));
+    out.write(reinterpret_cast<const char*>(&original_size), sizeof(original_size));
+    out.write(reinterpret_cast<const char*>(&encoded_size), sizeof(encoded_size));
+    out.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    ASSERT_TRUE(out.good());
+  }
+
+  const fs::path list_out = td.root / "list.txt";
+  const fs::path list_err = td.root / "list.err";
+  ASSERT_EQ(RunHamArcCapture({"--list", FileFlag(archive)}, list_out, list_err), 0);
+  EXPECT_NE(ReadAllText(list_out).find("old.bin (1024 bytes) [hamming]"), std::string::npos);
+
+  ASSERT_EQ(RunHamArc({"--append", FileFlag(archive), QuotePath(f2)}), 0);
+  ASSERT_EQ(RunHamArc({"--extract", FileFlag(archive)}, out_dir), 0);
+  EXPECT_TRUE(FilesEqual(f1, out_dir / "old.bin"));
+  EXPECT_TRUE(FilesEqual(f2, out_dir / "new.bin"));
+}
+
+TEST(HamArcCLI, ExtractUsesRecordedHammingParameters) {
+  TempDir td("hamarc_recorded_params");
+  const fs::path in_dir = td.root / "in";
+  const fs::path out_dir = td.root / "out";
+  ASSERT_TRUE(fs::create_directories(in_dir));
+  ASSERT_TRUE(fs::create_directories(out_dir));
+
+  const fs::path f1 = in_dir / "custom.bin";
+  WriteDeterministicFile(f1, 6 * 1024, 61);
+
+  const fs::path archive = td.root / "a.haf";
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(archive), "-D", "11", "-P", "4", QuotePath(f1)}), 0);
+
+  ASSERT_EQ(RunHamArc({"--extract", FileFlag(archive)}, out_dir), 0);
+  EXPECT_TRUE(FilesEqual(f1, out_dir / "custom.bin"));
+}
+
+TEST(HamArcCLI, StoreIfCompressedDetectsSignatures) {
+  TempDir td("hamarc_store_if");
+  const fs::path in_dir = td.root / "in";
+  const fs::path out_dir = td.root / "out";
+  ASSERT_TRUE(fs::create_directories(in_dir));
+  ASSERT_TRUE(fs::create_directories(out_dir));
+
+  const auto write_bytes = [](const fs::path& path, const std::string& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  };
+
+  const fs::path gzip = in_dir / "a.gz";
+  const fs::path bzip2 = in_dir / "b.bz2";
+  const fs::path text = in_dir / "c.txt";
+  const fs::path plain = in_dir / "d.bin";
+  write_bytes(gzip, std::string("\x1F\x8B\x08\x00payload", 11));
+  write_bytes(bzip2, std::string("BZh9\x31\x41\x59\x26\x53\x59payload", 17));
+  write_bytes(text, "BZh hello");
+  WriteDeterministicFile(plain, 1024, 71);
+
+  const fs::path archive = td.root / "a.haf";
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(archive), "--store-if=compressed", QuotePath(gzip),
+                       QuotePath(bzip2), QuotePath(text), QuotePath(plain)}), 0);
+
+  const fs::path list_out = td.root / "list.txt";
+  const fs::path list_err = td.root / "list.err";
+  ASSERT_EQ(RunHamArcCapture({"--list", FileFlag(archive)}, list_out, list_err), 0);
+  const std::string listing = ReadAllText(list_out);
+  EXPECT_NE(listing.find("a.gz (11 bytes) [stored]"), std::string::npos);
+  EXPECT_NE(listing.find("b.bz2 (17 bytes) [stored]"), std::string::npos);
+  EXPECT_NE(listing.find("c.txt (9 bytes) [hamming]"), std::string::npos);
+  EXPECT_NE(listing.find("d.bin (1024 bytes) [hamming]"), std::string::npos);
+
+  ASSERT_EQ(RunHamArc({"--extract", FileFlag(archive)}, out_dir), 0);
+  EXPECT_TRUE(FilesEqual(gzip, out_dir / "a.gz"));
+  EXPECT_TRUE(FilesEqual(bzip2, out_dir / "b.bz2"));
+  EXPECT_TRUE(FilesEqual(text, out_dir / "c.txt"));
+}
+
+TEST(HamArcCLI, StoredEntriesSurviveAppendDeleteAndConcatenate) {
+  TempDir td("hamarc_stored_rewrites");
+  const fs::path in_dir = td.root / "in";
+  const fs::path other_dir = td.root / "other";
+  const fs::path out_dir = td.root / "out";
+  const fs::path bad_dir = td.root / "bad";
+  ASSERT_TRUE(fs::create_directories(in_dir));
+  ASSERT_TRUE(fs::create_directories(other_dir));
+  ASSERT_TRUE(fs::create_directories(out_dir));
+  ASSERT_TRUE(fs::create_directories(bad_dir));
+
+  const fs::path a1 = in_dir / "a1.zip";
+  const fs::path b2 = in_dir / "b2.zip";
+  const fs::path keep = in_dir / "keep.dat";
+  const fs::path drop = in_dir / "drop.dat";
+  const fs::path notes = in_dir / "notes.txt";
+  const fs::path other = other_dir / "a1.zip";
+  WriteDeterministicFile(a1, 3000, 81);
+  WriteDeterministicFile(b2, 2000, 82);
+  WriteDeterministicFile(keep, 1500, 83);
+  WriteDeterministicFile(drop, 1000, 84);
+  WriteDeterministicFile(notes, 500, 85);
+  WriteDeterministicFile(other, 2500, 86);
+
+  const fs::path archive = td.root / "a.haf";
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(archive), "\"--store=a?.zip\"", "\"--store=keep.*\"",
+                       QuotePath(a1), QuotePath(keep), QuotePath(drop)}), 0);
+  ASSERT_EQ(RunHamArc({"--append", FileFlag(archive), "\"--store=b?.zip\"",
+                       QuotePath(b2), QuotePath(notes)}), 0);
+  ASSERT_EQ(RunHamArc({"--delete", FileFlag(archive), "drop.dat"}), 0);
+
+  const fs::path other_archive = td.root / "o.haf";
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(other_archive), "\"--store=*\"", QuotePath(other)}), 0);
+
+  const fs::path merged = td.root / "merged.haf";
+  ASSERT_EQ(RunHamArc({"--concatenate", FileFlag(merged), QuotePath(archive),
+                       QuotePath(other_archive)}), 0);
+
+  const fs::path list_out = td.root / "list.txt";
+  const fs::path list_err = td.root / "list.err";
+  ASSERT_EQ(RunHamArcCapture({"--list", FileFlag(merged)}, list_out, list_err), 0);
+  const std::string text = ReadAllText(list_out);
+  EXPECT_NE(text.find("a1.zip (3000 bytes) [stored]"), std::string::npos);
+  EXPECT_NE(text.find("keep.dat (1500 bytes) [stored]"), std::string::npos);
+  EXPECT_NE(text.find("b2.zip (2000 bytes) [stored]"), std::string::npos);
+  EXPECT_NE(text.find("notes.txt (500 bytes) [hamming]"), std::string::npos);
+  EXPECT_NE(text.find("a1.zip(2) (2500 bytes) [stored]"), std::string::npos);
+  EXPECT_EQ(text.find("drop.dat"), std::string::npos);
+
+  ASSERT_EQ(RunHamArc({"--extract", FileFlag(merged)}, out_dir), 0);
+  EXPECT_TRUE(FilesEqual(a1, out_dir / "a1.zip"));
+  EXPECT_TRUE(FilesEqual(keep, out_dir / "keep.dat"));
+  EXPECT_TRUE(FilesEqual(b2, out_dir / "b2.zip"));
+  EXPECT_TRUE(FilesEqual(notes, out_dir / "notes.txt"));
+  EXPECT_TRUE(FilesEqual(other, out_dir / "a1.zip(2)"));
+
+  // The checksum travelled with the entry, so damage is still detected.
+  FlipBitInFile(merged, fs::file_size(merged) - 1, /*bit_pos=*/0);
+  EXPECT_NE(RunHamArc({"--extract", FileFlag(merged), "\"a1.zip(2)\""}, bad_dir), 0);
+  EXPECT_FALSE(fs::exists(bad_dir / "a1.zip(2)"));
+}
+
+TEST(HamArcCLI, RepairUsesRecordedHammingParameters) {
+  TempDir td("hamarc_repair_params");
+  const fs::path in_dir = td.root / "in";
+  ASSERT_TRUE(fs::create_directories(in_dir));
+
+  const fs::path f1 = in_dir / "kept.bin";
+  const fs::path f2 = in_dir / "gone.bin";
+  WriteDeterministicFile(f1, 8 * 1024, 91);
+  WriteDeterministicFile(f2, 1024, 92);
+
+  const fs::path clean = td.root / "clean.haf";
+  const fs::path damaged = td.root / "damaged.haf";
+  ASSERT_EQ(RunHamArc({"--create", FileFlag(clean), "-D", "4", "-P", "3",
+                       QuotePath(f1), QuotePath(f2)}), 0);
+  fs::copy_file(clean, damaged);
+  FlipBitInFile(damaged, fs::file_size(damaged) / 2, /*bit_pos=*/5);
+
+  // No -D/-P here: the default 8/4 must not be used to "repair" a 4/3 entry.
+  ASSERT_EQ(RunHamArc({"--delete", FileFlag(clean), "gone.bin"}), 0);
+  ASSERT_EQ(RunHamArc({"--delete", FileFlag(damaged), "--repair", "gone.bin"}), 0);
+  EXPECT_TRUE(FilesEqual(clean, damaged));
+}
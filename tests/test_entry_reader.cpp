@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "archive_options.h"
+#include "archiver.h"
+#include "hamming_options.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr std::uint64_t kPageSize = 4096;
+
+struct ReaderTempDir {
+  fs::path root;
+  explicit ReaderTempDir(const std::string& prefix) {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+    root = fs::temp_directory_path() / (prefix + "_" + std::to_string(now));
+    std::error_code ec;
+    fs::create_directories(root, ec);
+  }
+  ~ReaderTempDir() {
+    std::error_code ec;
+    fs::remove_all(root, ec);
+  }
+};
+
+std::vector<char> MakeDeterministicData(std::size_t size, std::uint32_t seed) {
+  std::vector<char> data(size);
+  std::uint32_t x = seed;
+  for (char& byte : data) {
+    x = x * 1664525u + 1013904223u;
+    byte = static_cast<char>((x >> 24) & 0xFF);
+  }
+  return data;
+}
+
+// Archives `data` as `name` and returns the archive path.
+fs::path CreateArchive(const fs::path& dir, const std::string& name,
+                       const std::vector<char>& data, const hamarc::HammingOptions& hamming,
+                       const hamarc::ArchiveOptions& options = hamarc::ArchiveOptions{}) {
+  const fs::path input = dir / name;
+  {
+    std::ofstream out(input, std::ios::binary | std::ios::trunc);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+  }
+
+  const fs::path archive = dir / "reader.haf";
+  hamarc::Archiver archiver(archive.string(), hamming, options);
+  EXPECT_TRUE(archiver.Create({input.string()}));
+  return archive;
+}
+
+void ExpectRange(hamarc::EntryReader& reader, const std::vector<char>& data,
+                 std::uint64_t offset, std::uint64_t length) {
+  std::vector<char> buffer(length);
+  ASSERT_TRUE(reader.Read(offset, length, buffer.data()))
+      << "offset " << offset << ", length " << length;
+  EXPECT_TRUE(std::equal(buffer.begin(), buffer.end(),
+                         data.begin() + static_cast<std::ptrdiff_t>(offset)))
+      << "offset " << offset << ", length " << length;
+}
+
+}  // namespace
+
+TEST(EntryReader, ReadsAcrossPageBoundary) {
+  ReaderTempDir td("hamarc_reader_boundary");
+  const std::vector<char> data = MakeDeterministicData(3 * kPageSize + 100, 1);
+  const hamarc::HammingOptions hamming{8, 4};
+  const fs::path archive = CreateArchive(td.root, "data.bin", data, hamming);
+
+  hamarc::EntryReader reader(archive.string(), hamming);
+  ASSERT_TRUE(reader.Open("data.bin"));
+  EXPECT_EQ(reader.Size(), data.size());
+
+  ExpectRange(reader, data, kPageSize - 10, 20);
+  ExpectRange(reader, data, kPageSize - 1, 2 * kPageSize + 2);
+  ExpectRange(reader, data, 0, data.size());
+}
+
+TEST(EntryReader, ReadsShortLastPage) {
+  ReaderTempDir td("hamarc_reader_last_page");
+  const std::vector<char> data = MakeDeterministicData(2 * kPageSize + 37, 2);
+  const hamarc::HammingOptions hamming{8, 4};
+  const fs::path archive = CreateArchive(td.root, "data.bin", data, hamming);
+
+  hamarc::EntryReader reader(archive.string(), hamming);
+  ASSERT_TRUE(reader.Open("data.bin"));
+
+  ExpectRange(reader, data, 2 * kPageSize, 37);
+  ExpectRange(reader, data, data.size() - 1, 1);
+
+  std::vector<char> buffer(2);
+  EXPECT_FALSE(reader.Read(data.size() - 1, 2, buffer.data()));
+}
+
+TEST(EntryReader, ReadsWithNonByteAlignedCodewords) {
+  ReaderTempDir td("hamarc_reader_unaligned");
+  const std::vector<char> data = MakeDeterministicData(5 * kPageSize + 333, 3);
+  const hamarc::HammingOptions hamming{7, 4};
+  const fs::path archive = CreateArchive(td.root, "data.bin", data, hamming);
+
+  hamarc::EntryReader reader(archive.string(), hamming);
+  ASSERT_TRUE(reader.Open("data.bin"));
+
+  for (std::uint64_t offset : {std::uint64_t{1}, std::uint64_t{6}, std::uint64_t{7},
+                               kPageSize - 3, 3 * kPageSize + 5, data.size() - 11}) {
+    ExpectRange(reader, data, offset, std::min<std::uint64_t>(600, data.size() - offset));
+  }
+}
+
+TEST(EntryReader, ReadsStoredEntry) {
+  ReaderTempDir td("hamarc_reader_stored");
+  const std::vector<char> data = MakeDeterministicData(2 * kPageSize + 500, 4);
+  const hamarc::HammingOptions hamming{8, 4};
+  hamarc::ArchiveOptions options;
+  options.store_patterns = {"*.zip"};
+  const fs::path archive = CreateArchive(td.root, "packed.zip", data, hamming, options);
+
+  hamarc::EntryReader reader(archive.string(), hamming);
+  ASSERT_TRUE(reader.Open("packed.zip"));
+  EXPECT_EQ(reader.Size(), data.size());
+
+  ExpectRange(reader, data, kPageSize - 50, 100);
+  ExpectRange(reader, data, 2 * kPageSize, 500);
+}
+
+TEST(EntryReader, RereadsPagesAfterCacheEviction) {
+  ReaderTempDir td("hamarc_reader_eviction");
+  const std::uint64_t page_count = 20;
+  const std::vector<char> data = MakeDeterministicData(page_count * kPageSize, 5);
+  const hamarc::HammingOptions hamming{8, 4};
+  const fs::path archive = CreateArchive(td.root, "data.bin", data, hamming);
+
+  hamarc::EntryReader reader(archive.string(), hamming);
+  ASSERT_TRUE(reader.Open("data.bin"));
+
+  for (std::uint64_t page = 0; page < page_count; ++page) {
+    ExpectRange(reader, data, page * kPageSize + 10, 100);
+  }
+  ExpectRange(reader, data, 0, kPageSize);
+  ExpectRange(reader, data, (page_count - 1) * kPageSize, kPageSize);
+  ExpectRange(reader, data, kPageSize + 7, 3);
+}
+
+TEST(EntryReader, OpenMissingEntryFails) {
+  ReaderTempDir td("hamarc_reader_missing");
+  const std::vector<char> data = MakeDeterministicData(100, 6);
+  const hamarc::HammingOptions hamming{8, 4};
+  const fs::path archive = CreateArchive(td.root, "data.bin", data, hamming);
+
+  hamarc::EntryReader reader(archive.string(), hamming);
+  EXPECT_FALSE(reader.Open("absent.bin"));
+}